@@ -37,6 +37,21 @@ struct Operator: public Expr {
           : Expr(l), arg1(a1), arg2(a2), arg3(a3) { }
 };
 
+// A built-in reduction such as sum(i, lo, hi, expr).  The lexeme is the
+// keyword (kw_sum, kw_min, kw_max or kw_count); var is the induction variable
+// bound over the half-open range [lo, hi) while body is evaluated.
+struct Reduction: public Expr {
+    std::string             var;
+    std::unique_ptr<Expr>   lo;
+    std::unique_ptr<Expr>   hi;
+    std::unique_ptr<Expr>   body;
+
+    Reduction(int l, Name *v, Expr *lo_, Expr *hi_, Expr *b)
+          : Expr(l), var(v->value), lo(lo_), hi(hi_), body(b) {
+        delete v;
+    }
+};
+
 struct Function: public AST {
     std::string             name;
     std::string             arg;
@@ -1,7 +1,9 @@
+#include "llvm/Analysis/TargetTransformInfo.h"
 #include "llvm/ExecutionEngine/SectionMemoryManager.h"
 #include "llvm/Transforms/InstCombine/InstCombine.h"
 #include "llvm/Transforms/Scalar.h"
 #include "llvm/Transforms/Scalar/GVN.h"
+#include "llvm/Transforms/Vectorize.h"
 #include "JIT.h"
 #include <iostream>
 
@@ -58,15 +60,28 @@ int *JIT::getOrAddVariable(const std::string &name) {
     return &variableMap[name];
 }
 
-static void AddOptimizations(Module *module) {
+void JIT::addOptimizations(Module *module) {
+    // The vectorizers need to know the target to choose vector widths; without
+    // this they assume no vector registers and leave the loops alone.
+    module->setDataLayout(layout);
+    module->setTargetTriple(target->getTargetTriple().str());
+
     // Pick a few optimization passes.  PassManagerBuilder can be used to
     // select the set of (many!) passes used by clang's -O1/-O2/-O3.
     legacy::FunctionPassManager fpm(module);
+    fpm.add(createTargetTransformInfoWrapperPass(target->getTargetIRAnalysis()));
     fpm.add(createInstructionCombiningPass());
     fpm.add(createReassociatePass());
     fpm.add(createGVNPass());
     fpm.add(createCFGSimplificationPass());
 
+    // Vectorize the loops produced by the reduction built-ins, then tidy up
+    // after them.
+    fpm.add(createLoopVectorizePass());
+    fpm.add(createSLPVectorizerPass());
+    fpm.add(createInstructionCombiningPass());
+    fpm.add(createCFGSimplificationPass());
+
     // Run passes on all functions (there's really only one) in the module.
     fpm.doInitialization();
     for (auto &f : *module)
@@ -77,7 +92,7 @@ static void AddOptimizations(Module *module) {
 void JIT::addOrReplaceFunction(const std::string &name,
                                std::unique_ptr<Module> module) {
     if (optimize)
-        AddOptimizations(module.get());
+        addOptimizations(module.get());
 
     if (printIR)
         errs() << *module;
@@ -109,7 +124,7 @@ void JIT::execute(std::unique_ptr<Module> module,
                   const std::string &name,
                   void (*lambda)(cmd_t cmd)) {
     if (optimize)
-        AddOptimizations(module.get());
+        addOptimizations(module.get());
 
     if (printIR)
         errs() << *module;
@@ -47,6 +47,7 @@ public:
     bool    optimize = false;
 
 private:
+    void addOptimizations(llvm::Module *module);
     intptr_t findSymbol(llvm::orc::VModuleKey modkey, const std::string &name);
 
     // Declare the layers of the ORC JIT engine.  Based off the Kaleidoscope
@@ -1,5 +1,6 @@
 #include "llvm/IR/LLVMContext.h"
 #include "llvm/IR/BasicBlock.h"
+#include <climits>
 #include <string>
 
 #include "codegen.h"
@@ -80,6 +81,11 @@ Value *Codegen::translate(Expr *e) {
             return doAssign(e);
         case '(':
             return doCall(e);
+        case kw_sum:
+        case kw_min:
+        case kw_max:
+        case kw_count:
+            return doReduction(e);
     }
 
     // Should never reach here.
@@ -87,9 +93,15 @@ Value *Codegen::translate(Expr *e) {
 }
 
 Value *Codegen::doName(Expr *e) {
+    // Induction variables of enclosing reductions shadow everything else;
+    // search from the innermost one outwards.
+    Name *n = static_cast<Name *>(e);
+    for (auto it = locals.rbegin(); it != locals.rend(); ++it)
+        if (it->first == n->value)
+            return it->second;
+
     // If the name is the same as the function argument, return that as
     // the value.
-    Name *n = static_cast<Name *>(e);
     if (n->value == argName)
         return &*func->arg_begin();
 
@@ -224,6 +236,105 @@ Value *Codegen::doAssign(Expr *e) {
     return rhs;
 }
 
+Value *Codegen::doReduction(Expr *e) {
+    // A reduction is lowered to a real counted loop rather than a chain of
+    // calls, so that the optimizer's loop and SLP vectorizers can turn it into
+    // SIMD code.  The shape is the canonical bottom-tested loop:
+    //
+    //   entry:  if (lo < hi) goto loop; else goto exit;
+    //   loop:   i = phi(lo, i+1); acc = phi(init, acc')
+    //           acc' = combine(acc, body(i))
+    //           if (i+1 < hi) goto loop; else goto exit;
+    //   exit:   result = phi(init, acc')
+    Reduction *r = static_cast<Reduction *>(e);
+    Value *lo = translate(r->lo.get());
+    Value *hi = translate(r->hi.get());
+
+    // The identity of each reduction is also its value over an empty range.
+    Value *init;
+    switch (r->lexeme) {
+        case kw_min:
+            init = ConstantInt::get(int32ty, INT_MAX);
+            break;
+        case kw_max:
+            init = ConstantInt::get(int32ty, INT_MIN);
+            break;
+        default:
+            init = ConstantInt::get(int32ty, 0);
+            break;
+    }
+
+    BasicBlock *bbEntry = bb;
+    BasicBlock *bbLoop = BasicBlock::Create(ctx, "", func);
+    BasicBlock *bbExit = BasicBlock::Create(ctx, "", func);
+
+    // Skip the loop entirely if the range is empty.
+    Value *any = CmpInst::Create(Instruction::ICmp, ICmpInst::ICMP_SLT,
+                                 lo, hi, "", bb);
+    BranchInst::Create(bbLoop, bbExit, any, bb);
+
+    // The induction variable and the accumulator are phi nodes at the top of
+    // the loop.  Their back edge values are filled in once the body has been
+    // translated, as the body may itself introduce new basic blocks.
+    bb = bbLoop;
+    PHINode *iv = PHINode::Create(int32ty, 2, "", bb);
+    PHINode *acc = PHINode::Create(int32ty, 2, "", bb);
+    iv->addIncoming(lo, bbEntry);
+    acc->addIncoming(init, bbEntry);
+
+    // Translate the body with the induction variable in scope.
+    locals.emplace_back(r->var, iv);
+    Value *v = translate(r->body.get());
+    locals.pop_back();
+
+    // Fold the body's value into the accumulator.  For count, any non-zero
+    // value counts as true; for the others, a bool is widened to an int32.
+    if (r->lexeme == kw_count && v->getType() == int32ty)
+        v = CmpInst::Create(Instruction::ICmp, ICmpInst::ICMP_NE, v,
+                            ConstantInt::get(int32ty, 0), "", bb);
+    if (v->getType() != int32ty)
+        v = CastInst::Create(Instruction::ZExt, v, int32ty, "", bb);
+
+    Value *next;
+    switch (r->lexeme) {
+        case kw_min:
+        case kw_max: {
+            // Use the compare-and-select idiom, which the vectorizers
+            // recognize as a min/max reduction.
+            auto pred = r->lexeme == kw_min ? ICmpInst::ICMP_SLT
+                                            : ICmpInst::ICMP_SGT;
+            Value *c = CmpInst::Create(Instruction::ICmp, pred, v, acc,
+                                       "", bb);
+            next = SelectInst::Create(c, v, acc, "", bb);
+            break;
+        }
+        default:
+            next = BinaryOperator::Create(Instruction::Add, acc, v, "", bb);
+            break;
+    }
+
+    // Step the induction variable.  As i < hi, i + 1 cannot overflow; saying
+    // so lets LLVM compute the trip count.
+    auto step = BinaryOperator::Create(Instruction::Add, iv,
+                                       ConstantInt::get(int32ty, 1), "", bb);
+    step->setHasNoSignedWrap();
+    Value *more = CmpInst::Create(Instruction::ICmp, ICmpInst::ICMP_SLT,
+                                  step, hi, "", bb);
+    BranchInst::Create(bbLoop, bbExit, more, bb);
+
+    // Close the loop; bb is now the latch, which may differ from bbLoop.
+    iv->addIncoming(step, bb);
+    acc->addIncoming(next, bb);
+
+    // The exit block merges the empty range case with the loop's result.
+    BasicBlock *bbLatch = bb;
+    bb = bbExit;
+    PHINode *pn = PHINode::Create(int32ty, 2, "", bb);
+    pn->addIncoming(init, bbEntry);
+    pn->addIncoming(next, bbLatch);
+    return pn;
+}
+
 Value *Codegen::getVarAddr(const std::string &name) {
     // Get the LLVM type for intptr_t.
     Type *addrTy = sizeof(void *) == 4 ? int32ty
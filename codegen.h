@@ -1,4 +1,7 @@
 #include "llvm/IR/Instructions.h"
+#include <string>
+#include <utility>
+#include <vector>
 
 #pragma once
 
@@ -25,6 +28,9 @@ private:
 
     std::string          argName;
 
+    // Induction variables of the enclosing reductions, innermost last.
+    std::vector<std::pair<std::string, llvm::Value *>> locals;
+
     llvm::Value *translate(Expr *e);
     llvm::Value *doName(Expr *e);
     llvm::Value *doNumber(Expr *e);
@@ -34,6 +40,7 @@ private:
     llvm::Value *doCmp(Expr *e, llvm::ICmpInst::Predicate op);
     llvm::Value *doCall(Expr *e);
     llvm::Value *doAssign(Expr *e);
+    llvm::Value *doReduction(Expr *e);
 
     llvm::Value *getVarAddr(const std::string &name);
 };
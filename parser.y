@@ -17,11 +17,16 @@ AST *yyparsetree = nullptr;
     Expr        *expr;
     Function    *func;
     AST         *ast;
+    int          lexeme;
 }
 
 // Tokens in addition to the usual single-character suspects.
 %token          kw_fun
 %token          kw_quit
+%token          kw_sum
+%token          kw_min
+%token          kw_max
+%token          kw_count
 %token          op_neg    // distinguishes unary from binary '-'
 %token          EOL       // because bison doesn't support '\n'
 %token <name>   t_name
@@ -44,6 +49,7 @@ AST *yyparsetree = nullptr;
 %type <expr>    Expr;
 %type <func>    Function;
 %type <ast>     Line;
+%type <lexeme>  Reduce;
 
 %%
 
@@ -61,6 +67,17 @@ Function:
         { $$ = new Function(kw_fun, $2, $4, $7); }
     ;
 
+Reduce:
+      kw_sum
+        { $$ = kw_sum; }
+    | kw_min
+        { $$ = kw_min; }
+    | kw_max
+        { $$ = kw_max; }
+    | kw_count
+        { $$ = kw_count; }
+    ;
+
 Expr:
       t_name
         { $$ = $1; }
@@ -70,6 +87,8 @@ Expr:
         { $$ = $2; }
     | t_name '(' Expr ')'
         { $$ = new Operator('(', $1, $3); }
+    | Reduce '(' t_name ',' Expr ',' Expr ',' Expr ')'
+        { $$ = new Reduction($1, $3, $5, $7, $9); }
     | t_name '=' Expr
         { $$ = new Operator('=', $1, $3); }
     | Expr '+' Expr